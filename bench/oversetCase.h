@@ -0,0 +1,149 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef OVERSETCASE_H
+#define OVERSETCASE_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TiogaMeshInfo.h"
+
+namespace TIOGA {
+class tioga;
+}
+
+/** parameters of a synthetic overset system */
+struct oversetCaseParams
+{
+    enum shapeType { SPHERE = 0, CYLINDER };
+    enum elementMix { HEX = 0, PRISM, TET, MIXED };
+    enum backgroundType { UNSTRUCTURED = 0, AMR };
+
+    int nbodies{1};          /** < bodies, on a lattice in [-1,1]^3 */
+    shapeType shape{SPHERE}; /** < wall surface of the bodies */
+    elementMix elements{HEX}; /** < near-body cells; MIXED: prism layers at
+                                 the wall, then hexahedra, then tetrahedra */
+    int nface{8};   /** < cells along a cube face edge of a body surface */
+    int nlayers{8}; /** < cell layers from the wall to the outer boundary */
+    backgroundType background{UNSTRUCTURED};
+    int nback{32};    /** < background cells per side (level 0 for AMR) */
+    int nlevels{2};   /** < AMR levels, the finer ones around the bodies */
+    int patchSize{8}; /** < AMR patch cells per side */
+    int nghost{2};    /** < AMR ghost cells */
+    int nvar{5};      /** < solution variables */
+};
+
+/**
+ * Generator of a synthetic overset system, partitioned over the ranks of a
+ * communicator: bodies with a closed wall (sphere, or a cylinder with flat
+ * caps) meshed by a shell of cell layers around a cubed-sphere surface,
+ * embedded in a background that is either an unstructured hexahedral block
+ * or AMR patches refined around the bodies. Each rank builds only its own
+ * part, so the size is not limited by one node.
+ *
+ * The shells of the bodies are split into parts of face rows, given to the
+ * ranks round robin; the unstructured background is split in slabs and the
+ * AMR patches are dealt round robin. Node global ids are unique over all
+ * meshes. The blocks and patches are handed to tioga through MeshBlockInfo
+ * and AMRMeshInfo, the solution is a linear field in the coordinates, which
+ * all interpolations reproduce exactly.
+ */
+class oversetCase
+{
+public:
+    oversetCase(const oversetCaseParams& params, int myid, int nproc);
+    ~oversetCase();
+
+    oversetCase(const oversetCase&) = delete;
+    oversetCase& operator=(const oversetCase&) = delete;
+
+    /** register the near-body blocks, the background and their solution */
+    void registerGrids(TIOGA::tioga& tg);
+    void registerSolution(TIOGA::tioga& tg);
+
+    /** rigid motion of the bodies: translation of amplitude amp, phase t */
+    void moveBodies(double t, double amp);
+
+    /** the linear field at all points; the receptors keep it too, as the
+        donor cells may have receptor nodes, so a wrong donor or weight
+        shows up in solutionError but a missing update does not */
+    void setSolution();
+
+    /** largest local error of the interpolated values at the receptors,
+        nbad: receptors off by more than round-off */
+    double solutionError(long long* nbad = nullptr) const;
+
+    /** local sizes: [near-body nodes, near-body cells, background nodes,
+        background cells, AMR patches] */
+    void localSizes(long long sizes[5]) const;
+
+    /** local counts of [receptors, holes] */
+    void localBlanking(long long counts[2]) const;
+
+    const oversetCaseParams& getParams() const { return params; }
+
+    /** "sphere x4, hex 8x8, amr 32 (2 levels)" */
+    std::string describe() const;
+
+private:
+    struct unstructuredBlock;
+    struct amrPatch;
+
+    oversetCaseParams params;
+    int myid;
+    int nproc;
+
+    std::vector<double> bodyCenter; /** < [3*nbodies] at rest */
+    std::vector<double> bodyShift;  /** < [3*nbodies] of moveBodies */
+    double spacing;                 /** < distance of the body lattice */
+    double wallRadius;
+    double outerRadius;
+    double aspect; /** < cylinder half height over radius */
+
+    std::vector<std::unique_ptr<unstructuredBlock>> blocks;
+    std::vector<std::unique_ptr<amrPatch>> patches; /** < local patches */
+    TIOGA::AMRMeshInfo amrInfo;
+    // patch data common to all ranks, [ngrids_global] or [3*ngrids_global]
+    std::vector<int> amrLevel;
+    std::vector<int> amrRank;
+    std::vector<int> amrLocalId;
+    std::vector<int> amrIlow;
+    std::vector<int> amrIhigh;
+    std::vector<int> amrDims;
+    std::vector<double> amrXlo;
+    std::vector<double> amrDx;
+    // local patch data, [ngrids_local]
+    std::vector<int> amrGlobalId;
+    std::vector<int*> amrIblankCell;
+    std::vector<int*> amrIblankNode;
+    std::vector<double*> amrQcell;
+    std::vector<double*> amrQnode;
+
+    void buildBody(int body, int part, int nparts);
+    void buildUnstructuredBackground();
+    void buildAMRBackground();
+
+    /** point of surface lattice node (ix,iy,iz) of a body at radius r */
+    void surfacePoint(
+        int body, int ix, int iy, int iz, double r, double* xp) const;
+};
+
+#endif /* OVERSETCASE_H */
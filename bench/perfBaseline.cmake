@@ -0,0 +1,22 @@
+# Collect the metrics of the last performance test runs into a baseline:
+#
+#   cmake -DRESULTS=<dir of the results> -DOUTPUT=<baseline> -P perfBaseline.cmake
+#
+# Each result file <scenario>.json becomes the entry of that scenario.
+
+cmake_minimum_required(VERSION 3.19)
+
+file(GLOB results ${RESULTS}/*.json)
+if (NOT results)
+  message(FATAL_ERROR "no results in ${RESULTS}, run ctest -L perf first")
+endif()
+
+set(baseline "{ \"scenarios\": {} }")
+foreach (f ${results})
+  get_filename_component(scenario ${f} NAME_WE)
+  file(READ ${f} result)
+  string(JSON metrics GET ${result} metrics)
+  string(JSON baseline SET ${baseline} scenarios ${scenario} ${metrics})
+endforeach()
+file(WRITE ${OUTPUT} "${baseline}\n")
+message(STATUS "baseline of ${RESULTS} written to ${OUTPUT}")
@@ -0,0 +1,113 @@
+# Performance regression check of one scenario, run by ctest as
+#
+#   cmake -DEXE=... -DARGS=... -DNP=... -DMPIEXEC=... -DSCENARIO=...
+#         -DBASELINE=... -DRESULT=... -DTIME_TOLERANCE=... -DTIME_FLOOR=...
+#         -DCOUNT_TOLERANCE=... -DSTRICT_TIMES=... -DSTRICT_RUNS=...
+#         -P perfCheck.cmake
+#
+# Runs tioga_scaling with NP ranks, which writes the metrics of the run to
+# RESULT, and compares them with the entry SCENARIO of the JSON baseline:
+#
+#   { "scenarios": { "<scenario>": { "<metric>": <integer>, ... }, ... } }
+#
+# A count (allocations, messages, blanking and the search work of
+# TIOGA_OUTPUT_STATS) fails if it exceeds its baseline by more than
+# COUNT_TOLERANCE percent. The "time." metrics (in microseconds) depend on
+# the machine and its load: exceeding the baseline by more than
+# TIME_TOLERANCE percent plus TIME_FLOOR only warns, unless STRICT_TIMES
+# is set. Then the scenario runs STRICT_RUNS times and the median of each
+# time is checked and written to RESULT. A scenario missing from the
+# baseline passes with a note.
+
+cmake_minimum_required(VERSION 3.19)
+
+separate_arguments(ARGS)
+separate_arguments(MPIEXEC_PREFLAGS)
+set(nruns 1)
+if (STRICT_TIMES AND STRICT_RUNS GREATER 1)
+  set(nruns ${STRICT_RUNS})
+endif()
+foreach (run RANGE 1 ${nruns})
+  file(REMOVE ${RESULT})
+  execute_process(
+    COMMAND ${MPIEXEC} ${MPIEXEC_NUMPROC_FLAG} ${NP} ${MPIEXEC_PREFLAGS}
+            ${EXE} ${ARGS} --json=${RESULT}
+    RESULT_VARIABLE status)
+  if (NOT status EQUAL 0 OR NOT EXISTS ${RESULT})
+    message(FATAL_ERROR "${SCENARIO}: tioga_scaling failed (${status})")
+  endif()
+  file(READ ${RESULT} result)
+  if (run EQUAL 1)
+    set(first ${result})
+  endif()
+  # times of each run, the counts of all runs are the same
+  string(JSON nmetrics LENGTH ${result} metrics)
+  math(EXPR last "${nmetrics} - 1")
+  foreach (i RANGE ${last})
+    string(JSON name MEMBER ${result} metrics ${i})
+    if (name MATCHES "^time\\.")
+      string(JSON value GET ${result} metrics ${name})
+      list(APPEND runs_${name} ${value})
+    endif()
+  endforeach()
+endforeach()
+
+# median time of the runs
+set(result ${first})
+if (nruns GREATER 1)
+  string(JSON nmetrics LENGTH ${result} metrics)
+  math(EXPR last "${nmetrics} - 1")
+  math(EXPR middle "${nruns} / 2")
+  foreach (i RANGE ${last})
+    string(JSON name MEMBER ${result} metrics ${i})
+    if (name MATCHES "^time\\.")
+      list(SORT runs_${name} COMPARE NATURAL)
+      list(GET runs_${name} ${middle} median)
+      string(JSON result SET ${result} metrics ${name} ${median})
+    endif()
+  endforeach()
+  file(WRITE ${RESULT} "${result}\n")
+endif()
+
+file(READ ${BASELINE} baseline)
+string(JSON expected ERROR_VARIABLE missing GET ${baseline} scenarios ${SCENARIO})
+if (missing)
+  message(STATUS "${SCENARIO}: no baseline, nothing compared")
+  return()
+endif()
+
+set(failed "")
+string(JSON nmetrics LENGTH ${expected})
+math(EXPR last "${nmetrics} - 1")
+foreach (i RANGE ${last})
+  string(JSON name MEMBER ${expected} ${i})
+  string(JSON base GET ${expected} ${name})
+  string(JSON value ERROR_VARIABLE absent GET ${result} metrics ${name})
+  if (absent)
+    list(APPEND failed "${name} (not measured)")
+    continue()
+  endif()
+  set(status "ok")
+  if (name MATCHES "^time\\.")
+    math(EXPR limit "${base} + ${base} * ${TIME_TOLERANCE} / 100 + ${TIME_FLOOR}")
+    if (value GREATER limit AND STRICT_TIMES)
+      set(status "REGRESSION")
+      list(APPEND failed "${name} ${value} > ${limit}")
+    elseif (value GREATER limit)
+      set(status "slower")
+      message(WARNING "${SCENARIO}: ${name} ${value} > ${limit} (advisory)")
+    endif()
+  else()
+    math(EXPR limit "${base} + ${base} * ${COUNT_TOLERANCE} / 100")
+    if (value GREATER limit)
+      set(status "REGRESSION")
+      list(APPEND failed "${name} ${value} > ${limit}")
+    endif()
+  endif()
+  message(STATUS "${SCENARIO}: ${name} ${value} (baseline ${base}) ${status}")
+endforeach()
+
+if (failed)
+  string(REPLACE ";" "\n  " failed "${failed}")
+  message(FATAL_ERROR "${SCENARIO}: regressions against ${BASELINE}:\n  ${failed}")
+endif()
@@ -43,12 +43,6 @@ extern "C" {
                                          "PRISM  ", \
                                          "HEX    "  }
 
-// Globals
-std::vector<double> node_x;
-std::vector<int> element_node[TYPE_NUM_MAX];
-std::vector<int> wbc;
-std::vector<int> obc;
-
 #define TYPE_NNODES (int[9]){0,1,2,3,4,4,5,6,8}
 static
 void elementTypeName(int type){
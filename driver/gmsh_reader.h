@@ -0,0 +1,186 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef GMSH_READER_H
+#define GMSH_READER_H
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "TiogaMeshInfo.h"
+
+/** volume mesh read by gmshReader and the storage its MeshBlockInfo
+    points to */
+struct gmshMesh
+{
+    TIOGA::MeshBlockInfo info;
+    std::vector<double> x;
+    std::vector<uint64_t> nodeGid; /** < gmsh tags of the nodes, sorted */
+    std::vector<uint64_t> cellGid; /** < gmsh tags of the cells, by type */
+    std::vector<int> nv;           /** < vertices of each cell type */
+    std::vector<int> nc;           /** < cells of each cell type */
+    std::vector<std::vector<int>> conn; /** < 1-based local node indices */
+    std::vector<int> wall;    /** < wall nodes, set by the application */
+    std::vector<int> overset; /** < overset nodes, set by the application */
+    std::vector<int> iblank;
+    std::vector<int> iblankCell;
+    std::vector<double> q;
+
+    int numNodes() const { return static_cast<int>(nodeGid.size()); }
+    long long numCells() const;
+
+    /** size the iblank and solution arrays and point info to the storage */
+    void finalize(int meshtag, int nvar);
+};
+
+/**
+ * Memory mapped reader of gmsh 2.2 and 4.1 meshes, ASCII or binary.
+ *
+ * open() maps the file and indexes the node and element sections: the
+ * line starts of chunks of the ASCII sections, the element blocks and the
+ * number of volume elements (tetrahedra, pyramids, prisms and hexahedra,
+ * high order ones by their vertices). read() then parses the volume
+ * elements of a range, in file order, and only the nodes they use, so
+ * that the ranks of a partitioned run each read their share of the file.
+ * The chunks are parsed by all OpenMP threads.
+ */
+class gmshReader
+{
+public:
+    gmshReader();
+    ~gmshReader();
+
+    gmshReader(const gmshReader&) = delete;
+    gmshReader& operator=(const gmshReader&) = delete;
+
+    /** map and index fname, returns 0 on success, see error() */
+    int open(const char* fname);
+
+    double version() const { return fileVersion; }
+    bool binary() const { return isBinary; }
+    size_t numNodes() const { return nnodes; }
+    size_t numVolumeElements() const { return nvolume; }
+
+    /** volume elements [begin,end) in file order and their nodes, returns
+        0 on success */
+    int read(size_t begin, size_t end, gmshMesh& m);
+
+    /** contiguous share of rank of nranks of the volume elements */
+    int readPartition(int rank, int nranks, gmshMesh& m);
+
+    const std::string& error() const { return message; }
+
+private:
+    /** start of the lines of an ASCII section, by chunks of lines */
+    struct lineIndex
+    {
+        std::vector<const char*> chunk; /** < [nchunks+1] line starts */
+        std::vector<size_t> first;      /** < [nchunks+1] first line */
+
+        void build(const char* begin, const char* end);
+        size_t numLines() const { return first.back(); }
+        int numChunks() const { return static_cast<int>(chunk.size()) - 1; }
+        const char* line(size_t l) const;
+        const char* next(const char* p) const;
+    };
+
+    /** run of elements: one gmsh 4 entity block, a gmsh 2 binary block
+        of one type or a chunk of lines of a gmsh 2 ASCII file */
+    struct elementBlock
+    {
+        int type;           /** < gmsh type, -1: mixed (gmsh 2 ASCII) */
+        int ntags;          /** < tags per element (gmsh 2 binary) */
+        size_t count;       /** < elements */
+        size_t volumeBegin; /** < volume elements before the block */
+        size_t nvolume;     /** < volume elements in the block */
+        size_t line;        /** < first element line (ASCII) */
+        const char* data;   /** < first element record (binary) */
+    };
+
+    /** run of nodes: one gmsh 4 entity block or all nodes of gmsh 2 */
+    struct nodeBlock
+    {
+        size_t count;
+        size_t stride;    /** < reals per node (parametric gmsh 4) */
+        size_t tagLine;   /** < line of the first tag (ASCII) */
+        size_t xLine;     /** < line of the first coordinates (ASCII) */
+        const char* tags; /** < first tag (binary) */
+        const char* x;    /** < first coordinates (binary) */
+    };
+
+    /** volume elements parsed by one work item, by tioga cell type */
+    struct cellList
+    {
+        std::vector<uint64_t> tag[4];
+        std::vector<uint64_t> node[4];
+    };
+
+    /** local index of the node tags of the cells: a table over the range
+        of the tags when it is dense enough, a search of the sorted tags
+        otherwise */
+    struct tagIndex
+    {
+        const std::vector<uint64_t>* tags;
+        uint64_t lo;
+        std::vector<int> table;
+
+        /** index of tag in tags, tags->size() if it is not there */
+        size_t find(uint64_t tag) const;
+    };
+
+    const char* data;
+    size_t size;
+    double fileVersion;
+    bool isBinary;
+    size_t nnodes;
+    size_t nvolume;
+    lineIndex nodeLines;
+    lineIndex elementLines;
+    std::vector<nodeBlock> nodeBlocks;
+    std::vector<elementBlock> elementBlocks;
+    std::string message;
+
+    void close();
+    int fail(const std::string& msg);
+    int index();
+    const char* indexNodes(const char* p, const char* end);
+    const char* indexElements(const char* p, const char* end);
+    int readNodes(gmshMesh& m, const tagIndex& need);
+
+    /** elements [begin,end) of block b, counted in volume elements */
+    bool parseElements(
+        const elementBlock& b, size_t begin, size_t end, cellList& out)
+        const;
+
+    /** coordinates of the nodes [begin,end) of block b whose tags are in
+        need, at their index in need */
+    bool parseNodes(
+        const nodeBlock& b,
+        size_t begin,
+        size_t end,
+        const tagIndex& need,
+        double* x,
+        char* found) const;
+
+    /** tag of node i of block b, 0 if it cannot be read */
+    uint64_t nodeTag(const nodeBlock& b, size_t i) const;
+};
+
+#endif /* GMSH_READER_H */
@@ -22,11 +22,14 @@
 #define CARTBLOCK_H
 
 #include "codetypes.h"
+#include "connectivityArena.h"
+#include "vtkWriter.h"
 #include <cassert>
 #include <cstdlib>
+#include <stdint.h>
+#include <vector>
 
-struct INTERPLIST2;
-struct DONORLIST;
+struct CARTINTERP;
 struct HOLEMAP;
 
 namespace TIOGA {
@@ -34,6 +37,8 @@ struct AMRMeshInfo;
 }
 
 class CartGrid;
+class checkpointWriter;
+class checkpointFile;
 class CartBlock
 {
 private:
@@ -49,10 +54,18 @@ private:
     double dx[3];
     int ndonors;
     int interpListSize;
-    INTERPLIST2 *interpList, *listptr;
-    DONORLIST** donorList;
+    CARTINTERP *interpList, *listptr;
+    std::vector<int> donorOffset; /**< CSR offsets of the donors of each cell
+                                     and node (cells first) */
+    std::vector<DONORCANDIDATE2>
+        donorList; /**< donors of all points, best first per point */
+    connectivityArena* arena; /** < owner of the list nodes, set by tioga */
     void (*donor_frac)(int*, double*, int*, double*);
 
+    template <typename HoleMap>
+    void processIblankPlanes(
+        HoleMap* holemap, int nmesh, bool isNodal, int kbeg, int kend);
+
 public:
     CartBlock()
     {
@@ -63,7 +76,7 @@ public:
         qcell = nullptr;
         qnode = nullptr;
         interpListSize = 0;
-        donorList = nullptr;
+        arena = nullptr;
         interpList = nullptr;
         donor_frac = nullptr;
         nvar_cell = 0;
@@ -71,6 +84,8 @@ public:
     };
     ~CartBlock() { clearLists(); };
 
+    void setArena(connectivityArena* a) { arena = a; }
+
     void registerData(int lid, TIOGA::AMRMeshInfo* minfo);
     void registerSolution(int lid, TIOGA::AMRMeshInfo* minfo);
 
@@ -95,6 +110,7 @@ public:
     };
     int num_cell_var() const { return nvar_cell; }
     int num_node_var() const { return nvar_node; }
+    bool hasNodeIblank() const { return ibl_node != nullptr; }
     void preprocess(CartGrid* cg);
     void getInterpolatedData(
         int* nints, int* nreals, int** intData, double** realData);
@@ -102,8 +118,26 @@ public:
     void getCancellationData(int* cancelledData, int* ncancel);
     void processDonors(HOLEMAP* holemap, int nmesh);
     void processDonors(ADAPTIVE_HOLEMAP* holemap, int nmesh);
-    void processIblank(HOLEMAP* holemap, int nmesh, bool isNodal);
-    void processIblank(ADAPTIVE_HOLEMAP* holemap, int nmesh, bool isNodal);
+    /** iblanks and donor cancellation of the k-planes kbeg..kend-1 of the
+        cells or nodes (kend<0: all planes), disjoint ranges of planes can
+        be processed concurrently */
+    void processIblank(
+        HOLEMAP* holemap, int nmesh, bool isNodal, int kbeg = 0, int kend = -1);
+    void processIblank(
+        ADAPTIVE_HOLEMAP* holemap,
+        int nmesh,
+        bool isNodal,
+        int kbeg = 0,
+        int kend = -1);
+    int numPlanes(bool isNodal) const { return dims[2] + (isNodal ? 1 : 0); }
+    int planeSize(bool isNodal) const
+    {
+        return isNodal ? (dims[0] + 1) * (dims[1] + 1) : dims[0] * dims[1];
+    }
+    int donorPointIndex(int index) const;
+    void countDonor(int index) { donorOffset[donorPointIndex(index) + 1]++; }
+    void allocateDonorList();
+    void sortDonorList();
     void insertInDonorList(
         int senderid,
         int index,
@@ -114,6 +148,17 @@ public:
     void insertInInterpList(
         int procid, int remoteid, int remoteblockid, double* xtmp);
     void writeCellFile(int bid);
+    /** binary VTK piece of the patch without its ghost layers: cell iblank,
+        node iblank if nodeIblank and the cell and node solution */
+    vtkWriter vtkPiece(bool nodeIblank) const;
+    /** connectivity checkpoint of the patch (see connectivityCheckpoint.h),
+        after preprocess */
+    uint64_t meshChecksum() const;
+    void writeCheckpoint(checkpointWriter& w, int ib) const;
+    int checkCheckpoint(const checkpointFile& f, int ib) const;
+    /** iblanks and interpolation list of patch ib, the list records stay
+        in the mapped file */
+    void restoreCheckpoint(const checkpointFile& f, int ib);
     void clearLists();
     void initializeLists();
 };
@@ -64,6 +64,19 @@ public:
     registerData(int nf, const int* idata, const double* rdata, int ngridsin);
     void preprocess();
     void search(double* x, int* donorid, int npts);
+    /** search that keeps the donors of a previous search: points at the
+        same place as before keep their donor patch if it did not change
+        and no changed patch (changed[j]!=0) contains them */
+    void search(
+        double* x,
+        int* donorid,
+        int npts,
+        const double* xold,
+        const int* dold,
+        int nold,
+        const char* changed);
+    bool containsPoint(int j, const double* xp) const;
+    int findDonor(const double* xp) const;
     void setcallback(void (*f1)(int*, double*, int*, double*))
     {
         donor_frac = f1;
@@ -24,14 +24,21 @@
 #include "ADT.h"
 #include "TiogaMeshInfo.h"
 #include "codetypes.h"
+#include "connectivityArena.h"
+#include "searchCounters.h"
+#include "vtkWriter.h"
 #include <algorithm>
 #include <assert.h>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 // forward declare to instantiate one of the methods
 class parallelComm;
 class CartGrid;
+class recordWriter;
+class checkpointWriter;
+class checkpointFile;
 
 /**
  * MeshBlock class - container and functions for generic unstructured grid
@@ -99,7 +106,10 @@ private:
     //
     ADT* adt; /** < Digital tree for searching this block */
     //
-    DONORLIST** donorList; /**< list of donors for the nodes of this mesh */
+    std::vector<int> donorOffset; /**< CSR offsets of donor candidates per node
+                                     (nnodes+1), fill cursor while building */
+    std::vector<DONORCANDIDATE>
+        donorList; /**< donor candidates, sorted by donorRes per node */
     //
     int ninterp; /**< number of interpolations to be performed */
     int interpListSize;
@@ -145,7 +155,10 @@ public:
     int ntotalPointsCart;
     double* rxyzCart;
     int* donorIdCart;
-    int donorListLength;
+    std::vector<double>
+        rxyzCartLast; /** < rxyzCart of the last performConnectivityAMR */
+    std::vector<int>
+        donorIdCartLast; /** < donorIdCart of the last performConnectivityAMR */
 
     int nfringe;
     int mexclude;
@@ -170,7 +183,27 @@ public:
     int* donorId;       /** < donor indices for those found */
     std::vector<uint64_t>
         gid_search; /** < Global node ID for the query points */
+    std::vector<uint64_t>
+        key_search; /** < persistent key of the query points across calls */
     int donorCount;
+    //
+    // incremental search: donor cells of the previous search are
+    // re-checked first and only the failures are searched in the ADT
+    //
+    int incrementalSearch;       /** < [0] full search, [1] reuse donors */
+    double incrementalThreshold; /** < fraction of failed re-checks above
+                                    which a full search is done */
+    std::unordered_map<uint64_t, int>
+        donorCache;     /** < query point key -> donor cell of last search */
+    std::unordered_map<uint64_t, int>
+        donorCacheCart; /** < donorCache of the Cartesian receptors */
+    int nsearchReused;  /** < donors reused in the last search */
+    int nsearchQueried; /** < points searched in the ADT in the last search */
+    std::vector<searchCounters, cacheLineAllocator<searchCounters>>
+        searchStats; /** < [thread] work of the searches, TIOGA_OUTPUT_STATS */
+    std::vector<int>
+        presetDonorId; /** < [nsearch] donors of query points searched by a
+                          peer rank (-2: search here), see balanceSearch */
 
     int myid;               /** < global mpi rank */
     int blockcomm_id;       /** < mpi rank within this block */
@@ -193,6 +226,11 @@ public:
     INTERPLIST* interpListCart;
     int* receptorIdCart;
 
+    connectivityArena* arena; /** < owner of the interpolation and cancel
+                                 lists, reset every performConnectivity */
+    connectivityArena* cartArena; /** < same for the Cartesian receptor and
+                                     interpolation lists (AMR connectivity) */
+
     int* vconn_ptrs[TIOGA::MeshBlockInfo::max_vertex_types];
 
     //
@@ -218,7 +256,6 @@ public:
         elementBbox = nullptr;
         elementList = nullptr;
         adt = nullptr;
-        donorList = nullptr;
         interpList = nullptr;
         interp2donor = nullptr;
         obb = nullptr;
@@ -260,6 +297,8 @@ public:
         ninterpCart = 0;
         interpListCartSize = 0;
         interpListCart = nullptr;
+        arena = nullptr;
+        cartArena = nullptr;
         resolutionScale = 1.0;
         receptorIdCart = nullptr;
         searchTol = TOL;
@@ -274,6 +313,11 @@ public:
         invmap = nullptr;
         icft = nullptr;
         mapmask = nullptr;
+        incrementalSearch = 0;
+        incrementalThreshold = 0.25;
+        nsearchReused = 0;
+        nsearchQueried = 0;
+        searchStats.resize(searchCounterThreads());
     };
 
     /** basic destructor */
@@ -289,6 +333,13 @@ public:
 
     void writeFlowFile(int bid, double* q, int nvar, int type);
 
+    /** binary VTK piece of the block: nodes, cells, iblank, donor candidate
+        count, orphans and the nvar solution variables (type as in
+        writeFlowFile), with the cell iblank if cellIblank. The arrays are
+        read from the block when the piece is written */
+    vtkWriter
+    vtkPiece(const double* q, int nvar, int type, bool cellIblank) const;
+
     void setData(TIOGA::MeshBlockInfo* minfo);
 
     void setData(
@@ -311,6 +362,25 @@ public:
 
     void search();
     void search_uniform_hex();
+
+    /** query points of this block can be searched by a peer rank */
+    int canOffloadSearch() const { return static_cast<int>(uniform_hex == 0); }
+
+    /** ADT built by the last search() over the cells near its query
+        points, nullptr before the first one */
+    ADT* getADT() const { return adt; }
+
+    /** pack the query points plist[npts] with the cells that may contain
+        them for a search on a peer rank of the same body */
+    void getGuestSearchData(
+        int npts,
+        const int* plist,
+        std::vector<int>& idata,
+        std::vector<double>& rdata);
+
+    /** search the points packed by getGuestSearchData on a peer rank,
+        donors are cell indices in the block that packed them */
+    void searchGuest(const int* idata, const double* rdata, int* donors) const;
     void writeOBB(int bid) const;
 
     void writeOBB2(OBB* obc, int bid);
@@ -338,6 +408,26 @@ public:
 
     void checkContainment(int* cellIndex, int adtElement, double* xsearch);
 
+    void checkCellContainment(int* cellIndex, int icell, double* xsearch);
+
+    void clearDonorCache() { donorCache.clear(); }
+
+    /** search counters of the calling thread, see TIOGA_SEARCH_COUNT */
+    searchCounters& searchCounter()
+    {
+        return searchStats[searchCounterThread()];
+    }
+
+    /** search counters summed over the threads */
+    searchCounters getSearchCounters() const
+    {
+        searchCounters c;
+        for (const auto& t : searchStats) {
+            c += t;
+        }
+        return c;
+    }
+
     void getWallBounds(int* mtag, int* existWall, double wbox[6]);
 
     void markWallBoundary(int* sam, int nx[3], const double extents[6]);
@@ -386,9 +476,15 @@ public:
 
     void getDonorPacket(PACKET* sndPack, int nsend) const;
 
+    /** donor candidates are gathered in CSR form : reset the counts, count
+        the candidates of each node, allocate, fill and sort per node */
     void initializeDonorList();
 
-    void insertAndSort(
+    void countDonor(int pointid) { donorOffset[pointid + 1]++; }
+
+    void allocateDonorList();
+
+    void insertDonor(
         int pointid,
         int senderid,
         int meshtag,
@@ -396,6 +492,36 @@ public:
         double donorRes,
         double receptorRes);
 
+    void sortDonorList();
+
+    /** donor candidates of a connectivity record, in place of the
+        exchange (tioga_replay) */
+    void setDonorList(
+        const std::vector<int>& offset, const std::vector<DONORCANDIDATE>& list)
+    {
+        donorOffset = offset;
+        donorList = list;
+    }
+
+    /** connectivity record sections (see connectivityRecord.h): MESH and
+        SRCH before search(), SRES after it, DONR before processDonors()
+        and DRES after it */
+    void writeSearchRecord(recordWriter& w) const;
+    void writeSearchResultRecord(recordWriter& w) const;
+    void writeDonorRecord(recordWriter& w) const;
+    void writeDonorResultRecord(recordWriter& w, int nrecords) const;
+
+    /** checksum of the nodes and cells the connectivity is computed on */
+    uint64_t meshChecksum() const;
+    /** connectivity checkpoint sections of the block (see
+        connectivityCheckpoint.h): iblanks and interpolation lists */
+    void writeCheckpoint(checkpointWriter& w, int ib) const;
+    /** returns 0 if the sections of block ib were written for this mesh */
+    int checkCheckpoint(const checkpointFile& f, int ib) const;
+    /** iblanks and interpolation lists of block ib, the inode and weights
+        stay in the mapped file */
+    void restoreCheckpoint(const checkpointFile& f, int ib);
+
     void processDonors(
         HOLEMAP* holemap,
         int nmesh,
@@ -449,6 +575,8 @@ public:
     {
         iblank_cell = iblank_cell_input;
     }
+
+    bool hasCellIblank() const { return iblank_cell != nullptr; }
     void setcallback(
         void (*f1)(int*, int*),
         void (*f2)(int*, int*, double*),
@@ -502,18 +630,11 @@ public:
     void clearOrphans(ADAPTIVE_HOLEMAP* holemap, int nmesh, int* itmp);
     void getUnresolvedMandatoryReceptors();
     void getCartReceptors(CartGrid* cg, parallelComm* pc);
-    void fillReceptorDataPtr(
-        CartGrid* cg,
-        int cell_count,
-        int c,
-        int j,
-        int k,
-        int l,
-        int* pmap,
-        double vol,
-        double* xtm,
-        bool isNodal,
-        INTEGERLIST2*& dataPtr);
+
+    /** search the receptors of getCartReceptors, with incremental!=0 the
+        donors of the last call are re-checked for the receptors of the
+        patches j not changed (changed[j]==0) */
+    void searchCartReceptors(int incremental, const char* changed, int ngrids);
     void setCartIblanks();
 
     // Getters
@@ -539,17 +660,19 @@ public:
      */
     void resetInterpData()
     {
-        if (interpList != nullptr) {
-            for (int i = 0; i < interpListSize; i++) {
-                if (interpList[i].inode != nullptr)
-                    TIOGA_FREE(interpList[i].inode);
-                if (interpList[i].weights != nullptr)
-                    TIOGA_FREE(interpList[i].weights);
-            }
-            TIOGA_FREE(interpList);
-        }
+        // inode/weights and the cancel list live in the arena
+        if (interpList != nullptr) TIOGA_FREE(interpList);
         ninterp = 0;
         interpListSize = 0;
+        cancelList = nullptr;
+        ncancel = 0;
+    }
+
+    /** arenas for the connectivity lifetime lists, owned by tioga */
+    void setArena(connectivityArena* a, connectivityArena* acart)
+    {
+        arena = a;
+        cartArena = acart;
     }
     void reduce_fringes();
 
@@ -0,0 +1,144 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef CELLKERNELS_H
+#define CELLKERNELS_H
+#include <cstddef>
+#include <utility>
+#include "codetypes.h"
+
+/**
+ * Linear passes over the cells of one element type of an unstructured
+ * mesh block. Kernels are templated on the vertex count NV so that the
+ * vertex loops of the standard element types are unrolled, NV=0 takes
+ * the vertex count at run time. Cells are split among threads when
+ * OpenMP is enabled; every kernel gives the result of a serial pass.
+ */
+/** run Kernel<NV>::run(nvert, args...) with NV matching nvert */
+template <template <int> class Kernel, typename... Args>
+inline void dispatchCellKernel(int nvert, Args&&... args)
+{
+    switch (nvert) {
+    case 4:
+        Kernel<4>::run(nvert, std::forward<Args>(args)...);
+        break;
+    case 5:
+        Kernel<5>::run(nvert, std::forward<Args>(args)...);
+        break;
+    case 6:
+        Kernel<6>::run(nvert, std::forward<Args>(args)...);
+        break;
+    case 8:
+        Kernel<8>::run(nvert, std::forward<Args>(args)...);
+        break;
+    default:
+        Kernel<0>::run(nvert, std::forward<Args>(args)...);
+        break;
+    }
+}
+
+/** cell iblank from the node iblanks: hole if any node is a hole,
+    fringe if all nodes are fringes (-1), field otherwise */
+template <int NV>
+struct cellIblankKernel
+{
+    static void run(
+        int nvert, int ncell, const int* conn, const int* ibl, int* iblCell)
+    {
+        int const nvc = (NV > 0) ? NV : nvert;
+        TIOGA_OMP(parallel for schedule(static))
+        for (int i = 0; i < ncell; i++) {
+            const int* c = conn + static_cast<size_t>(nvc) * i;
+            int nhole = 0;
+            int nfringe = 0;
+            for (int m = 0; m < nvc; m++) {
+                int const ib = ibl[c[m] - BASE];
+                nhole += static_cast<int>(ib == 0);
+                nfringe += static_cast<int>(ib == -1);
+            }
+            iblCell[i] = (nhole > 0) ? 0 : ((nfringe == nvc) ? -1 : 1);
+        }
+    }
+};
+
+/** tag1 = 1 on all nodes of cells with a node tagged (== 1) in tag;
+    tag1 must contain tag */
+template <int NV>
+struct spreadTagKernel
+{
+    template <typename T>
+    static void
+    run(int nvert, int ncell, const int* conn, const T* tag, T* tag1)
+    {
+        int const nvc = (NV > 0) ? NV : nvert;
+        TIOGA_OMP(parallel for schedule(static))
+        for (int i = 0; i < ncell; i++) {
+            const int* c = conn + static_cast<size_t>(nvc) * i;
+            int ntag = 0;
+            for (int m = 0; m < nvc; m++) {
+                ntag += static_cast<int>(tag[c[m] - BASE] == 1);
+            }
+            if (ntag > 0) {
+                for (int m = 0; m < nvc; m++) {
+                    TIOGA_OMP(atomic write)
+                    tag1[c[m] - BASE] = 1;
+                }
+            }
+        }
+    }
+};
+
+/** cells partially covered by field/fringe nodes of ibl keep their
+    fringe nodes: ibltmp = iblank on their nodes with iblank < 0. Such
+    nodes of ibltmp are either 0 or set to iblank already */
+template <int NV>
+struct partialCellKernel
+{
+    static void
+    run(int nvert,
+        int ncell,
+        const int* conn,
+        const int* ibl,
+        const int* iblank,
+        int* ibltmp)
+    {
+        int const nvc = (NV > 0) ? NV : nvert;
+        TIOGA_OMP(parallel for schedule(static))
+        for (int i = 0; i < ncell; i++) {
+            const int* c = conn + static_cast<size_t>(nvc) * i;
+            int ncount = 0;
+            for (int m = 0; m < nvc; m++) {
+                int const ib = ibl[c[m] - BASE];
+                ncount += static_cast<int>(ib == 1 || ib < 0);
+            }
+            if (ncount > 0 && ncount < nvc) {
+                for (int m = 0; m < nvc; m++) {
+                    int const node = c[m] - BASE;
+                    if (iblank[node] < 0) {
+                        TIOGA_OMP(atomic write)
+                        ibltmp[node] = iblank[node];
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif /* CELLKERNELS_H */
@@ -38,6 +38,17 @@ typedef int32_t qcoord_t;
 /*  Base for indexing (0 or 1) */
 /*====================================================================*/
 #define BASE 1
+/*====================================================================*/
+/*  OpenMP directive, compiled out without OpenMP so that the builds  */
+/*  without TIOGA_ENABLE_OPENMP do not warn about unknown pragmas:    */
+/*    TIOGA_OMP(parallel for schedule(static))                        */
+/*====================================================================*/
+#ifdef _OPENMP
+#define TIOGA_OMP_PRAGMA(...) _Pragma(#__VA_ARGS__)
+#define TIOGA_OMP(...) TIOGA_OMP_PRAGMA(omp __VA_ARGS__)
+#else
+#define TIOGA_OMP(...)
+#endif
 
 /*====================================================================*/
 /*  Define arithmetic constants                                       */
@@ -56,7 +67,7 @@ typedef int32_t qcoord_t;
 #define BIGVALUE 1.0e+15
 #define BIGINT 2147483647
 #define TOL 1.0e-10
-#define HOLEMAPSIZE 192
+#define HOLEMAPSIZE 192 // default resolution, see tioga::setHoleMapSize
 // #define NFRINGE            3
 // #define NVAR               6
 #define WALLNODETYPE 0
@@ -82,6 +93,8 @@ typedef int32_t qcoord_t;
 #define OCTANT_LEN(l) ((qcoord_t)1 << (OCTANT_MAXLEVEL - (l)))
 /** Conversion from integer coordinates to double coordinates */
 #define INT2DBL ((double)1.0 / (double)OCTANT_ROOT_LEN)
+/** Deepest level whose octant indices fit a 64-bit Morton key */
+#define OCTANT_MORTON_MAXLEVEL 21
 
 #define OUTSIDE_SB 0
 #define INSIDE_SB 1
@@ -164,18 +177,6 @@ typedef struct
     bound_t z; /**< z bounds */
 } box_t;
 
-/** The 3D full octant datatype: 130 bytes per octant */
-typedef struct octant_full
-{
-    qcoord_t x, y, z; /**< [12B] binary coordinates */
-    uint32_t id;      /**< [4B] element id on level */
-    uint8_t filltype; /**< [1B] floodfill: [0] inside SB, [1] outside SB, [2]
-                         hole SB */
-    uint8_t refined;  /**< [1B] flag if refined (i.e. is a parent) */
-    struct octant_full* nhbr[6];     /**< [48B] neighbor octant list */
-    struct octant_full* children[8]; /**< [64B] children octants if refined */
-} octant_full_t;
-
 typedef struct octant_coordinates
 {
     qcoord_t x, y, z; /**< [12B] binary coordinates */
@@ -192,14 +193,22 @@ typedef struct octant
     uint32_t children[8]; /**< [32B] children octant IDs */
 } octant_t;
 
+/** compact octant level of the adaptive hole map under construction:
+    octants are stored in Morton order, children of a refined octant are
+    found through the count of refined octants before it */
 typedef struct level_octant
 {
     uint32_t elem_count; /**< number of octants in level */
     uint8_t level_id;    /**< level number */
-    std::vector<octant_full_t>
-        octants; /**< [elem_count] locally stored octants */
+    std::vector<octant_coordinates_t> octants; /**< [12B] coordinates */
+    std::vector<uint8_t> filltype;             /**< [1B] floodfill type */
+    std::vector<uint8_t> refined;              /**< [1B] flag if refined */
 } level_octant_t;
 
+/** bytes per octant of a level: build data, boundary flags, final octant */
+#define AHM_OCTANT_BYTES                                                       \
+    (sizeof(octant_coordinates_t) + 4 * sizeof(uint8_t) + sizeof(octant_t))
+
 typedef struct level_octant_coordinate
 {
     uint8_t level_id;    /**< level number */
@@ -207,6 +216,15 @@ typedef struct level_octant_coordinate
     std::vector<octant_coordinates_t> octants; /**< [elem_count] octant list */
 } level_octant_coordinate_t;
 
+/** leaf octant of the linearized hole map query index */
+typedef struct ahm_leaf
+{
+    qcoord_t x, y, z; /**< [12B] binary coordinates */
+    uint8_t level;    /**< [1B]  level of the leaf */
+    uint8_t filltype; /**< [1B]  floodfill type of the leaf */
+    uint8_t pad[2];   /**< [2B]  padding */
+} ahm_leaf_t;
+
 typedef struct level
 {
     uint8_t level_id;              /**< level number */
@@ -250,8 +268,14 @@ typedef struct ADAPTIVE_HOLEMAP_COMPOSITE
 typedef struct ADAPTIVE_HOLEMAP
 {
     uint8_t existWall; /**< flag to indicate map contains wall */
+    uint8_t rigid;     /**< [1] query points are mapped by xform first */
+    double xform[12];  /**< rotation (row major) + translation taking
+                            query points to the frame of the map */
     ahm_meta_t meta;   /**< adaptive hole map meta data */
     level_t levels[OCTANT_MAXLEVEL];
+    std::vector<uint64_t> leafKey; /**< sorted Morton keys of the leaves on
+                                      the finest level (query index) */
+    std::vector<ahm_leaf_t> leaf;  /**< leaves in leafKey order */
 } ADAPTIVE_HOLEMAP;
 
 typedef struct HOLEMAP
@@ -261,6 +285,9 @@ typedef struct HOLEMAP
     int* samLocal;
     int* sam;
     double extents[6];
+    int rigid;        /**< [1] query points are mapped by xform first */
+    double xform[12]; /**< rotation (row major) + translation taking
+                           query points to the frame of the map */
 } HOLEMAP;
 
 typedef struct OBB
@@ -286,6 +313,21 @@ typedef struct DONORLIST
     struct DONORLIST* next;
 } DONORLIST;
 
+typedef struct DONORCANDIDATE
+{
+    int donorData[3]; /**< sender index, donor mesh tag, remote id */
+    double donorRes;
+    double receptorRes;
+} DONORCANDIDATE;
+
+typedef struct DONORCANDIDATE2
+{
+    int donorData[4]; /**< sender index, donor mesh tag, remote id, remote
+                         block id */
+    double donorRes;
+    int cancel;
+} DONORCANDIDATE2;
+
 typedef struct PACKET
 {
     int nints;
@@ -314,6 +356,18 @@ typedef struct INTERPLIST2
     struct INTERPLIST2* next;
 } INTERPLIST2;
 
+/** receptor of a Cartesian patch: the trilinear 2x2x2 stencils of the
+    cell and node data are the linear index of their first point, the
+    axes along which they advance and 8 weights each */
+typedef struct CARTINTERP
+{
+    int receptorInfo[3];
+    int base[2];        /**< [cell, node] linear index of stencil point 0 */
+    uint8_t step[2];    /**< [cell, node] bit n set: stencil spans axis n */
+    double weights[16]; /**< [cell, node] x 8 weights */
+    struct CARTINTERP* next;
+} CARTINTERP;
+
 typedef struct INTEGERLIST
 {
     int inode;
@@ -0,0 +1,146 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef COMMSTATS_H
+#define COMMSTATS_H
+#include "mpi.h"
+#include <map>
+#include <vector>
+
+/**
+ * Point to point traffic of the packet exchanges of parallelComm. Every
+ * exchange is charged to the phase set by the innermost label: number of
+ * messages, bytes and peers in both directions and the time spent waiting
+ * for completion. The bytes and messages sent are also kept per
+ * destination rank, which gives the sparse rank to rank volume matrix.
+ * Nothing is communicated while recording; reduce() and writePeerMatrix()
+ * are collective.
+ */
+class commStats
+{
+public:
+    enum phaseId {
+        EXCHANGE_BOXES = 0,
+        EXCHANGE_SEARCH_DATA,
+        EXCHANGE_DONORS,
+        EXCHANGE_AMR_DONORS,
+        DATA_UPDATE,
+        DATA_UPDATE_AMR,
+        REDUCE_FRINGES,
+        OTHER,
+        NPHASES
+    };
+
+    struct phase
+    {
+        long long calls;     /** < exchanges */
+        long long msgSent;   /** < messages posted to other ranks */
+        long long msgRecv;   /** < messages received from other ranks */
+        long long bytesSent; /** < bytes sent, handshakes included */
+        long long bytesRecv; /** < bytes received, handshakes included */
+        long long peersSent; /** < sum of the destination ranks per call */
+        long long peersRecv; /** < sum of the source ranks per call */
+        int maxPeers;        /** < most ranks of one call in one direction */
+        double waitTime;     /** < time spent in the waits */
+        // filled by reduce(), over the ranks
+        long long maxCalls;
+        long long totalMsg;       /** < messages sent by all ranks */
+        long long totalBytes;     /** < bytes sent by all ranks */
+        long long maxBytesSent;   /** < largest bytes sent by one rank */
+        long long maxBytesRecv;   /** < largest bytes received by one rank */
+        int maxPeersGlobal;       /** < largest maxPeers of one rank */
+        double avgPeers;          /** < destination ranks per call */
+        double waitMin, waitAvg, waitMax;
+    };
+
+    /** volume sent to one rank */
+    struct peerVolume
+    {
+        long long messages;
+        long long bytes;
+    };
+
+    /** charges the exchanges in its lifetime to a phase */
+    class label
+    {
+    public:
+        label(commStats& s, phaseId id) : stats(s), previous(s.current)
+        {
+            stats.current = id;
+        }
+        ~label() { stats.current = previous; }
+
+        label(const label&) = delete;
+        label& operator=(const label&) = delete;
+
+    private:
+        commStats& stats;
+        phaseId previous;
+    };
+
+    commStats() { reset(); }
+
+    void setEnabled(bool flag) { enabled = flag; }
+    bool isEnabled() const { return enabled; }
+
+    /** discard all counts */
+    void reset();
+
+    static const char* phaseName(int id);
+
+    const phase& getPhase(int id) const { return phases[id]; }
+
+    /** per destination rank volume of a phase on this rank */
+    const std::map<int, peerVolume>& getPeers(int id) const
+    {
+        return peers[id];
+    }
+
+    /** called by parallelComm around one exchange */
+    void beginExchange();
+    void addSend(int rank, long long nmsg, long long nbytes);
+    void addRecv(int rank, long long nmsg, long long nbytes);
+    void endExchange(double wait);
+
+    /** collective: totals, per rank maxima and wait min/avg/max */
+    void reduce(MPI_Comm comm);
+
+    /** table of the reduced counts on stdout */
+    void print() const;
+
+    /**
+     * Collective: write the nonzero entries of the volume matrix on the
+     * root as "src dst phase messages bytes" lines. Returns 0 on success
+     * on the root.
+     */
+    int writePeerMatrix(MPI_Comm comm, const char* fname) const;
+
+private:
+    bool enabled{false};
+    bool reduced{false};
+    int nranks{1};
+    phaseId current{OTHER};
+    phase phases[NPHASES];
+    std::vector<std::map<int, peerVolume>> peers;
+    int nsendPeers; /** < destination ranks of the open exchange */
+    int nrecvPeers; /** < source ranks of the open exchange */
+};
+
+#endif /* COMMSTATS_H */
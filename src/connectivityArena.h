@@ -0,0 +1,99 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef CONNECTIVITYARENA_H
+#define CONNECTIVITYARENA_H
+#include <cstddef>
+#include <vector>
+
+/**
+ * Bump allocator for the short lived objects of one connectivity epoch
+ * (donor/interpolation lists, cancel lists, receptor lists). Memory is
+ * handed out from large chunks and is never freed individually; reset()
+ * starts a new epoch in O(1) and reuses the chunks. The counters show how
+ * much small object traffic went through the arena and how many system
+ * allocations it took.
+ */
+class connectivityArena
+{
+private:
+    static constexpr size_t alignment = 16;
+
+    struct chunk
+    {
+        char* data;
+        size_t size;
+    };
+    std::vector<chunk> chunks; /** < chunks, kept across epochs */
+    size_t chunkSize;          /** < default size of a new chunk */
+    size_t icur;               /** < chunk being filled */
+    size_t used;               /** < bytes used in the current chunk */
+
+    long long nalloc;      /** < allocations in this epoch */
+    long long nbytes;      /** < bytes handed out in this epoch */
+    long long nallocTotal; /** < allocations since construction */
+    long long nsystem;     /** < chunk (system) allocations */
+    size_t capacityBytes;  /** < bytes held in chunks */
+    int nepoch;            /** < number of resets */
+
+    void* grow(size_t n);
+
+public:
+    explicit connectivityArena(size_t chunk_size = (1 << 20));
+    ~connectivityArena();
+
+    connectivityArena(const connectivityArena&) = delete;
+    connectivityArena& operator=(const connectivityArena&) = delete;
+
+    void* allocate(size_t n)
+    {
+        n = (n + alignment - 1) & ~(alignment - 1);
+        nalloc++;
+        nallocTotal++;
+        nbytes += n;
+        if (icur < chunks.size() && used + n <= chunks[icur].size) {
+            void* p = chunks[icur].data + used;
+            used += n;
+            return p;
+        }
+        return grow(n);
+    }
+
+    template <typename T>
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * n));
+    }
+
+    /** start a new epoch, everything handed out so far is released */
+    void reset();
+
+    /** release the chunks as well */
+    void release();
+
+    long long allocations() const { return nalloc; }
+    long long bytes() const { return nbytes; }
+    long long totalAllocations() const { return nallocTotal; }
+    long long systemAllocations() const { return nsystem; }
+    size_t capacity() const { return capacityBytes; }
+    int epoch() const { return nepoch; }
+};
+
+#endif /* CONNECTIVITYARENA_H */
@@ -0,0 +1,179 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef CONNECTIVITYCHECKPOINT_H
+#define CONNECTIVITYCHECKPOINT_H
+#include <cstddef>
+#include <cstdio>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Checkpoint of the connectivity of one rank, written by
+ * tioga::writeConnectivityCheckpoint and mapped back by
+ * tioga::restoreConnectivity so that dataUpdate runs without a
+ * performConnectivity after a restart.
+ *
+ * The file is a checkpointHeader, the sections and the table of the
+ * sections, in the native byte order. Each section is an array of one
+ * type, tagged with 4 characters and the index of its block, starting at
+ * a multiple of checkpointAlignment so that it is used in place once the
+ * file is mapped. The table holds a checksum of each section, the block
+ * sections a checksum of the mesh they were computed on.
+ *
+ *   PCMP  nsend, nrecv, sndMap and rcvMap of the near-body comm
+ *   PCCM  same for the Cartesian comm
+ *   MBLK  checkpointBlock of a mesh block
+ *   IBLK  iblank, IBLC iblank_cell
+ *   INTL  cancel, nweights, receptorInfo and stored weights of interpList
+ *   INOD  inode of interpList, IWGT weights (stored weights per entry)
+ *   CINL, CINO, CWGT  same for interpListCart
+ *   CBLK  checkpointBlock of a Cartesian block
+ *   CIBC  cell iblank, CIBN node iblank (with ghosts)
+ *   CINT  CARTINTERP list of the block
+ */
+const char checkpointMagic[8] = {'T', 'I', 'O', 'G', 'A', 'C', 'K', 'P'};
+const uint32_t checkpointVersion = 1;
+const uint32_t checkpointByteOrder = 0x01020304;
+const size_t checkpointAlignment = 64;
+
+struct checkpointHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; /** < checkpointByteOrder as written */
+    int32_t myid;
+    int32_t numprocs;
+    int32_t nblocks;
+    int32_t ncart;
+    int32_t ihighGlobal;
+    int32_t iamrGlobal;
+    uint64_t nsections;
+    uint64_t tableOffset;
+};
+
+struct checkpointSection
+{
+    char tag[4];
+    int32_t block;
+    uint64_t offset;
+    uint64_t nbytes;
+    uint64_t checksum;
+};
+
+/** block of the checkpoint and the mesh it was computed on */
+struct checkpointBlock
+{
+    int32_t meshtag; /** < global id of a Cartesian block */
+    int32_t npoints; /** < nodes (iblank values of a Cartesian block) */
+    int32_t ncells;  /** < cells (cell iblank values) */
+    int32_t hasCellIblank;
+    int32_t ninterp;
+    int32_t ninterpCart;
+    uint64_t meshChecksum;
+};
+
+/** 64-bit checksum of nbytes of data, continued from seed */
+uint64_t checkpointChecksum(const void* data, size_t nbytes, uint64_t seed = 0);
+
+class checkpointWriter
+{
+private:
+    FILE* fp;
+    uint64_t pos;
+    std::vector<checkpointSection> table;
+
+    /** pad the file to the next multiple of checkpointAlignment */
+    void align();
+
+public:
+    explicit checkpointWriter(const char* fname);
+    ~checkpointWriter();
+
+    checkpointWriter(const checkpointWriter&) = delete;
+    checkpointWriter& operator=(const checkpointWriter&) = delete;
+
+    bool good() const { return fp != nullptr; }
+
+    void put(const char* tag, int block, const void* data, size_t nbytes);
+
+    template <typename T>
+    void putArray(const char* tag, int block, const T* data, size_t n)
+    {
+        put(tag, block, data, sizeof(T) * n);
+    }
+
+    /** write the table and the header, returns 0 on success */
+    int close(checkpointHeader& h);
+};
+
+/** read only view of a mapped checkpoint */
+class checkpointFile
+{
+private:
+    char* base;
+    size_t size;
+    const checkpointHeader* h;
+    const checkpointSection* table;
+
+    const checkpointSection* find(const char* tag, int block) const;
+
+public:
+    checkpointFile() : base(nullptr), size(0), h(nullptr), table(nullptr) {}
+    ~checkpointFile();
+
+    checkpointFile(const checkpointFile&) = delete;
+    checkpointFile& operator=(const checkpointFile&) = delete;
+
+    /** map a checkpoint and check its header and table, returns 0 on
+        success, 1 if it cannot be opened, 2 if it is not a checkpoint of
+        this version and byte order, 3 if it is truncated */
+    int open(const char* fname);
+
+    /** compare the checksums of all sections, returns the number of
+        sections that differ */
+    int verify() const;
+
+    const checkpointHeader& header() const { return *h; }
+
+    /** section tag of block, nullptr if absent or not of n values of T
+        (any length if n is -1). The data is mapped copy on write: it can
+        be changed in place without changing the file */
+    template <typename T>
+    T* array(const char* tag, int block, long long n = -1) const
+    {
+        const checkpointSection* s = find(tag, block);
+        if (s == nullptr || s->nbytes % sizeof(T) != 0 ||
+            (n >= 0 && s->nbytes != sizeof(T) * static_cast<uint64_t>(n))) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(base + s->offset);
+    }
+
+    /** number of values of T in section tag of block, 0 if absent */
+    template <typename T>
+    size_t count(const char* tag, int block) const
+    {
+        const checkpointSection* s = find(tag, block);
+        return (s == nullptr) ? 0 : s->nbytes / sizeof(T);
+    }
+};
+
+#endif /* CONNECTIVITYCHECKPOINT_H */
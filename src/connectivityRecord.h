@@ -0,0 +1,164 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef CONNECTIVITYRECORD_H
+#define CONNECTIVITYRECORD_H
+#include "codetypes.h"
+#include <cstdio>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Binary record of everything one MeshBlock::search and processDonors call
+ * of performConnectivity work on, written by tioga::setConnectivityCapture
+ * and rerun on a single rank by bench/tioga_replay.
+ *
+ * The file is "TIOGAREC", an int version and a list of sections, each a
+ * 4 character tag, the uint64 size of its payload and the payload, in the
+ * native byte order. Arrays are a uint64 count followed by the values.
+ *
+ *   INFO  rank, call, block, number of meshes, hole map type
+ *   MESH  block settings, nodes, cells, boundary nodes, global IDs,
+ *         resolutions and OBB
+ *   SRCH  query points and the donor cache of the incremental search
+ *   SRES  donors found by the search
+ *   DONR  donor candidates received by the nodes of the block
+ *   HMAP  Cartesian hole maps of all meshes, run length encoded (or AHMP
+ *         adaptive hole maps)
+ *   DRES  iblank and number of receptors after processDonors
+ *   END
+ *
+ * The result sections are there to check a replay against the run.
+ */
+class recordWriter
+{
+private:
+    FILE* fp;
+    char tag[4];
+    std::vector<char> payload; /** < section being written */
+
+    void append(const void* data, size_t nbytes);
+
+public:
+    explicit recordWriter(const char* fname);
+    ~recordWriter();
+
+    recordWriter(const recordWriter&) = delete;
+    recordWriter& operator=(const recordWriter&) = delete;
+
+    bool good() const { return fp != nullptr; }
+
+    void beginSection(const char* name);
+    void endSection();
+
+    template <typename T>
+    void put(const T& value)
+    {
+        append(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(const T* data, size_t n)
+    {
+        uint64_t const count = n;
+        append(&count, sizeof(count));
+        if (n > 0) append(data, sizeof(T) * n);
+    }
+};
+
+/** the content of a record file, see recordWriter for the layout */
+struct connectivityRecord
+{
+    // INFO
+    int myid;
+    int call;
+    int block;
+    int nmesh;
+    int adaptiveHoleMap;
+    // MESH
+    int meshtag;
+    int check_uniform_hex_flag;
+    int incrementalSearch;
+    double incrementalThreshold;
+    int mexclude;
+    int nfringe;
+    int dominanceFlag;
+    int composite;
+    double resolutionScale;
+    double searchTol;
+    int nnodes;
+    std::vector<int> nv;
+    std::vector<int> nc;
+    std::vector<std::vector<int>> vconn;
+    std::vector<double> x;
+    std::vector<int> wbcnode;
+    std::vector<int> obcnode;
+    std::vector<uint64_t> nodeGID;
+    std::vector<uint64_t> cellGID;
+    std::vector<double> nodeRes;
+    std::vector<double> cellRes;
+    OBB obb;
+    // SRCH
+    int nsearch;
+    std::vector<double> xsearch;
+    std::vector<int> isearch;
+    std::vector<int> tagsearch;
+    std::vector<double> res_search;
+    std::vector<uint64_t> gid_search;
+    std::vector<uint64_t> key_search;
+    std::vector<int> presetDonorId;
+    std::vector<uint64_t> cacheKey; /** < donorCache of the last search */
+    std::vector<int> cacheCell;
+    // SRES
+    std::vector<int> donorId;
+    int nsearchReused;
+    // DONR
+    std::vector<int> donorOffset;
+    std::vector<DONORCANDIDATE> donorList;
+    // HMAP/AHMP
+    std::vector<HOLEMAP> holeMap;
+    std::vector<std::vector<int>> holeMapData; /** < sam of holeMap */
+    std::vector<ADAPTIVE_HOLEMAP> adaptiveHoleMapData;
+    // DRES
+    std::vector<int> iblank;
+    int nrecords;
+
+    bool hasSearch;
+    bool hasSearchResult;
+    bool hasDonors;
+    bool hasHoleMaps;
+    bool hasDonorResult;
+
+    connectivityRecord();
+
+    // holeMap points into holeMapData
+    connectivityRecord(const connectivityRecord&) = delete;
+    connectivityRecord& operator=(const connectivityRecord&) = delete;
+
+    /** load a record file, returns 0 on success */
+    int read(const char* fname);
+};
+
+/** hole maps of all meshes, sections HMAP and AHMP */
+void writeHoleMapRecord(recordWriter& w, const HOLEMAP* holemap, int nmesh);
+void writeHoleMapRecord(
+    recordWriter& w, const ADAPTIVE_HOLEMAP* holemap, int nmesh);
+
+#endif /* CONNECTIVITYRECORD_H */
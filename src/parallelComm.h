@@ -21,6 +21,7 @@
 #ifndef PARALLELCOMM_H
 #define PARALLELCOMM_H
 #include "codetypes.h"
+#include "commStats.h"
 #include "mpi.h"
 #include <cstdlib>
 
@@ -39,6 +40,11 @@ private:
     int nrecv;
     int* sndMap;
     int* rcvMap;
+    int selfSnd; /** index of this rank in sndMap (-1 if absent) */
+    int selfRcv; /** index of this rank in rcvMap (-1 if absent) */
+    commStats* stats; /** traffic counters, not owned (may be null) */
+
+    static void movePacket(PACKET& from, PACKET& to);
 
 public:
     int myid;
@@ -49,6 +55,8 @@ public:
     {
         sndMap = nullptr;
         rcvMap = nullptr;
+        selfSnd = selfRcv = -1;
+        stats = nullptr;
     }
 
     ~parallelComm()
@@ -61,16 +69,27 @@ public:
         }
     }
 
-    void sendRecvPacketsAll(PACKET* sndPack, PACKET* rcvPack) const;
+    void sendRecvPacketsAll(PACKET* sndPack, PACKET* rcvPack);
 
     void sendRecvPackets(PACKET* sndPack, PACKET* rcvPack);
 
     void sendRecvPacketsCheck(PACKET* sndPack, PACKET* rcvPack);
 
+    /** count the traffic of the exchanges in s */
+    void setStats(commStats* s) { stats = s; }
+
     void setMap(int ns, int nr, const int* snd, const int* rcv);
 
     void getMap(int* ns, int* nr, int** snd, int** rcv);
 
+    /** index of the packet in sndPack that is addressed to this rank,
+        -1 if this rank does not send to itself */
+    int selfSendIndex() const { return selfSnd; }
+
+    /** index of the packet in rcvPack that comes from this rank,
+        -1 if this rank does not receive from itself */
+    int selfRecvIndex() const { return selfRcv; }
+
     void initPackets(PACKET* sndPack, PACKET* rcvPack) const;
 
     void clearPackets(PACKET* sndPack, PACKET* rcvPack) const;
@@ -0,0 +1,123 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef PHASEPROFILER_H
+#define PHASEPROFILER_H
+#include "mpi.h"
+#include <string>
+#include <vector>
+
+/**
+ * Hierarchical wall clock profile of the connectivity and data update
+ * phases. Phases are named scopes nested by the order of their start/stop
+ * calls and are identified by their path, the names from the outermost
+ * scope joined by '/'. Each rank accumulates the time and the number of
+ * calls of every phase over all calls; nothing is synchronized while
+ * timing. reduce() is the only collective, it combines the ranks into the
+ * min/avg/max time of every phase.
+ */
+class phaseProfiler
+{
+public:
+    struct phase
+    {
+        std::string name; /** < name given to start() */
+        std::string path; /** < names from the outermost scope, '/' joined */
+        int parent;       /** < enclosing phase, -1 for an outermost one */
+        int depth;        /** < nesting level, 0 for an outermost one */
+        long long calls;  /** < completed calls on this rank */
+        double time;      /** < accumulated wall time on this rank */
+        double tstart;    /** < start time of the open call */
+        // filled by reduce()
+        long long maxCalls; /** < maximum of the calls over the ranks */
+        double tmin;        /** < minimum of the time over the ranks */
+        double tavg;        /** < average of the time over the ranks */
+        double tmax;        /** < maximum of the time over the ranks */
+    };
+
+    /** starts a phase on construction and stops it on destruction */
+    class scope
+    {
+    public:
+        scope(phaseProfiler& p, const char* name) : prof(p), pname(name)
+        {
+            prof.start(pname);
+        }
+        ~scope() { prof.stop(pname); }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        phaseProfiler& prof;
+        const char* pname;
+    };
+
+    /** switching discards the open phases */
+    void setEnabled(bool flag);
+    bool isEnabled() const { return enabled; }
+
+    /** open a phase nested in the currently open one */
+    void start(const char* name);
+
+    /** close the innermost phase, which should be called name */
+    void stop(const char* name);
+
+    /** discard all phases and their times */
+    void reset();
+
+    int numPhases() const { return static_cast<int>(phases.size()); }
+    const phase& getPhase(int i) const { return phases[i]; }
+
+    /** index of the phase with the given path, -1 if there is none */
+    int findPhase(const char* path) const;
+
+    /** accumulated time of a phase on this rank, 0 if there is none */
+    double getTime(const char* path) const;
+
+    /**
+     * Collective over comm. Phases are matched by their path, every rank
+     * ends up with the union of the phases in the same order, a phase a
+     * rank never entered counts as zero time there. Phases open during the
+     * call only contribute their completed calls.
+     */
+    void reduce(MPI_Comm comm);
+
+    /** true once reduce() was called, until the next start() or reset() */
+    bool isReduced() const { return reduced; }
+
+    /** number of ranks of the last reduce() */
+    int numRanks() const { return nranks; }
+
+    /** table of the reduced profile on stdout */
+    void print() const;
+
+    /** reduced profile as a JSON document, returns 0 on success */
+    int writeJSON(const char* fname) const;
+
+private:
+    bool enabled{false};
+    bool reduced{false};
+    int current{-1}; /** < innermost open phase */
+    int nranks{1};
+    std::vector<phase> phases;
+};
+
+#endif /* PHASEPROFILER_H */
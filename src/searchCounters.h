@@ -0,0 +1,171 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef SEARCHCOUNTERS_H
+#define SEARCHCOUNTERS_H
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * Work counters of the donor search of one mesh block and one thread,
+ * accumulated over all searches. Each thread owns a copy aligned to whole
+ * cache lines (in a vector with cacheLineAllocator), so counting needs no
+ * atomics and threads do not share lines. Only compiled in with
+ * TIOGA_OUTPUT_STATS, see TIOGA_SEARCH_COUNT.
+ */
+struct alignas(64) searchCounters
+{
+    static constexpr int nbins = 16; /** < log2 histogram bins */
+
+    long long queries{0};      /** < unique points searched in the ADT */
+    long long duplicates{0};   /** < query points sharing a unique point */
+    long long cacheHits{0};    /** < donors reused by the incremental mode */
+    long long cacheMisses{0};  /** < cached donors failing the re-check */
+    long long nodesVisited{0}; /** < ADT nodes visited */
+    long long boxOverlaps{0};  /** < ADT element boxes holding the point */
+    long long containmentTests{0}; /** < cell containment tests */
+    long long newtonSolves{0};     /** < Newton solves for nodal weights */
+    long long newtonIterations{0}; /** < iterations of these solves */
+    long long hexHits{0};   /** < donors found by the uniform hex map */
+    long long hexMisses{0}; /** < uniform hex map lookups without donor */
+    long long noDonor{0};   /** < unique points without a donor */
+    long long nodesHist[nbins]{};  /** < ADT nodes visited per query */
+    long long testsHist[nbins]{};  /** < containment tests per query */
+    long long newtonHist[nbins]{}; /** < iterations per Newton solve */
+
+    /** number of long long fields, in declaration order from queries */
+    static constexpr int nfields = 12 + 3 * nbins;
+
+    void clear() { *this = searchCounters(); }
+
+    /** bin of n in a log2 histogram: 0, 1, 2-3, 4-7, ... */
+    static int bin(long long n)
+    {
+        int b = 0;
+        while (n > 0 && b < nbins - 1) {
+            n >>= 1;
+            b++;
+        }
+        return b;
+    }
+
+    /** the fields as one array, for sums and reductions */
+    long long* data() { return &queries; }
+    const long long* data() const { return &queries; }
+
+    void addNewton(int nvert, int niter)
+    {
+        if (nvert > 4) {
+            newtonSolves++;
+            newtonIterations += niter;
+            newtonHist[bin(niter)]++;
+        }
+    }
+
+    searchCounters& operator+=(const searchCounters& o)
+    {
+        long long* a = data();
+        const long long* b = o.data();
+        for (int i = 0; i < nfields; i++) {
+            a[i] += b[i];
+        }
+        return *this;
+    }
+};
+
+// data() and the reductions see the fields as one array of nfields
+static_assert(
+    offsetof(searchCounters, newtonHist) +
+            sizeof(searchCounters::newtonHist) ==
+        searchCounters::nfields * sizeof(long long),
+    "searchCounters::nfields does not match the fields");
+
+/**
+ * Allocator of 64 byte aligned storage: before C++17 std::allocator does
+ * not honor the alignment of searchCounters.
+ */
+template <typename T>
+struct cacheLineAllocator
+{
+    using value_type = T;
+
+    cacheLineAllocator() = default;
+    template <typename U>
+    cacheLineAllocator(const cacheLineAllocator<U>& /*other*/)
+    {}
+
+    T* allocate(size_t n)
+    {
+        void* p = nullptr;
+        if (posix_memalign(&p, 64, n * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t /*n*/) { free(p); }
+};
+
+template <typename T, typename U>
+bool operator==(const cacheLineAllocator<T>&, const cacheLineAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const cacheLineAllocator<T>&, const cacheLineAllocator<U>&)
+{
+    return false;
+}
+
+inline int searchCounterThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+inline int searchCounterThread()
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+//
+// statement on the counters of this thread of mesh block mb,
+// compiled out without TIOGA_OUTPUT_STATS:
+//   TIOGA_SEARCH_COUNT(mb, containmentTests++);
+//
+#ifdef TIOGA_OUTPUT_STATS
+#define TIOGA_SEARCH_COUNT(mb, stmt) ((mb)->searchCounter().stmt)
+#else
+#define TIOGA_SEARCH_COUNT(mb, stmt) ((void)0)
+#endif
+
+#endif /* SEARCHCOUNTERS_H */
@@ -24,10 +24,17 @@
 #include "CartBlock.h"
 #include "CartGrid.h"
 #include "MeshBlock.h"
+#include "commStats.h"
+#include "connectivityArena.h"
+#include "connectivityCheckpoint.h"
+#include "connectivityRecord.h"
 #include "parallelComm.h"
+#include "phaseProfiler.h"
+#include <array>
 #include <map>
 #include <memory>
 #include <stdint.h>
+#include <string>
 #include <vector>
 
 /** Define a macro entry flagging the versions that are safe to use with large
@@ -107,6 +114,64 @@ private:
     //! q-variables registered
     double** qblock;
 
+    //! Incremental connectivity: reuse the donors of the previous call
+    int incrementalConnectivity;
+    //! Fraction of failed donor re-checks that triggers a full search
+    double incrementalThreshold;
+    //! Discard all cached donors in the next performConnectivity
+    int fullConnectivityRequested;
+
+    //! Rigid body motion of mesh tags: rotation (row major) + translation
+    std::map<int, std::array<double, 12>> rigidMotion;
+    //! Rigid body motion of mesh tags when the hole maps were built
+    std::map<int, std::array<double, 12>> holeMapMotion;
+    //! Hole map algorithm of the cached rigid body hole maps (-1: none)
+    int rigidHoleMapAlg;
+    //! Memory cap of one adaptive hole map level in bytes (0: no cap)
+    size_t ahmLevelMemory;
+    //! Cells of the Cartesian hole map along the longest wall extent
+    int holeMapSize;
+    //! Share the search load among the ranks of a body: [0] off, [1] on
+    int searchBalance;
+    //! Load above (1+tolerance)*average that is moved to other ranks
+    double searchBalanceTol;
+
+    //! AMR patch records of the last performConnectivityAMR
+    std::vector<int> amrPatchInts;
+    std::vector<double> amrPatchReals;
+    //! AMR patches new or changed since the last performConnectivityAMR
+    std::vector<char> amrPatchChanged;
+    int nAMRPatchChanged;
+    //! Discard all cached AMR donors in the next performConnectivityAMR
+    int fullAMRConnectivityRequested;
+    //! AMR patch records of the last preprocess_amr_data broadcast
+    std::vector<int> amrBcastInts;
+    std::vector<double> amrBcastReals;
+    //! [1] cg is a copy of the AMR grid made by preprocess_amr_data
+    int amrGridMirror;
+
+    //! Lists of one performConnectivity call (interpolation/cancel lists)
+    connectivityArena arena;
+    //! Lists of one performConnectivityAMR call (Cartesian donors/receptors)
+    connectivityArena cartArena;
+
+    //! Phase times of the connectivity and data update calls
+    phaseProfiler profiler;
+    //! Traffic of the packet exchanges of pc and pc_cart
+    commStats commStatistics;
+
+    //! Record of the search and processDonors inputs, see
+    //! setConnectivityCapture
+    std::string capturePrefix;
+    int captureRank;       /** < rank that records, -1: all ranks */
+    int captureCalls;      /** < performConnectivity calls left to record */
+    int connectivityCalls; /** < performConnectivity calls so far */
+    std::vector<std::unique_ptr<recordWriter>>
+        captureFiles; /** < [nblocks] records of the current call */
+
+    //! Checkpoint mapped by restoreConnectivity, holds the restored lists
+    std::unique_ptr<checkpointFile> checkpoint;
+
 public:
     int ihigh;
     int ihighGlobal;
@@ -142,6 +207,24 @@ public:
         mexclude = 3, nfringe = 1;
         USE_ADAPTIVE_HOLEMAP = 0; // Default to original hole map
         qblock = nullptr;
+        incrementalConnectivity = 0;
+        incrementalThreshold = 0.25;
+        fullConnectivityRequested = 0;
+        rigidHoleMapAlg = -1;
+        ahmLevelMemory = 0;
+        holeMapSize = HOLEMAPSIZE;
+        searchBalance = 0;
+        searchBalanceTol = 0.1;
+        nAMRPatchChanged = 0;
+        fullAMRConnectivityRequested = 0;
+        amrGridMirror = 0;
+        captureRank = -1;
+        captureCalls = 0;
+        connectivityCalls = 0;
+#ifdef TIOGA_ENABLE_TIMERS
+        profiler.setEnabled(true);
+        commStatistics.setEnabled(true);
+#endif
         mblocks.clear();
         mtags.clear();
     }
@@ -207,6 +290,8 @@ public:
 
     void exchangeSearchData(int at_points = 0);
 
+    void balanceSearch();
+
     void exchangeDonors();
 
     /** perform overset grid connectivity */
@@ -226,12 +311,24 @@ public:
     void getHoleMap();
     void getAdaptiveHoleMap();
 
+    /** reuse rigid body hole maps in the frame they were built in */
+    bool reuseRigidHoleMaps();
+    void saveRigidHoleMapMotion();
+
     /** output HoleMaps */
     void outputHoleMap();
     void outputAdaptiveHoleMap();
 
     void writeData(int nvar, int interptype);
 
+    /** binary VTK output of the connectivity: one .vtu piece per mesh block
+        (<prefix>.r<rank>.b<block>.vtu) and AMR patch (<prefix>.amr.r...)
+        with the .pvtu indices written by one rank, and the hole maps */
+    void writeVTK(const char* prefix, int nvar, int interptype);
+    /** hole maps of the meshes with walls, <prefix>.holemap<mesh>.vti for
+        the Cartesian and .vtu (leaf octants) for the adaptive ones */
+    void writeHoleMapVTK(const char* prefix);
+
     void getDonorCount(int btag, int* dcount, int* fcount);
 
     void getDonorInfo(
@@ -246,6 +343,17 @@ public:
     /** set hole map algorithm: [0] original hole map, [1] adaptive hole map */
     void setHoleMapAlgorithm(int alg) { USE_ADAPTIVE_HOLEMAP = alg; };
     int getHoleMapAlgorithm() const { return USE_ADAPTIVE_HOLEMAP; };
+    /** cap the memory of one adaptive hole map level, refinement stops at
+        the last level that fits (0: no cap) */
+    void setAdaptiveHoleMapLevelMemory(size_t bytes) { ahmLevelMemory = bytes; }
+    /** resolution of the Cartesian hole map: cells along the longest
+        extent of the walls of a body (default HOLEMAPSIZE) */
+    void setHoleMapSize(int n)
+    {
+        holeMapSize = n;
+        rigidHoleMapAlg = -1;
+    }
+    int getHoleMapSize() const { return holeMapSize; }
     /** set symmetry bc */
     void setSymmetry(int syminput) { isym = syminput; };
     /** set resolutions for nodes and cells */
@@ -267,6 +375,125 @@ public:
 
     void setNfringe(const int* nfringe_input) { nfringe = *nfringe_input; }
 
+    /** incremental connectivity for moving meshes: [0] off, [1] re-check
+        the donors of the previous call and search only the failures and
+        new points. More than threshold*(cached points) failures in a
+        block turn the search of that block into a full search. In
+        performConnectivityAMR only the receptors of new or changed AMR
+        patches are searched and the near-body points keep their patch
+        unless a changed patch covers them */
+    void setIncrementalConnectivity(int flag, double threshold = 0.25)
+    {
+        incrementalConnectivity = flag;
+        incrementalThreshold = threshold;
+    }
+
+    /** load balanced search: ranks of a body with more than
+        (1+tolerance) times the average number of query points send the
+        excess, with the cells around them, to ranks of the body below the
+        average and get the donors back. Needs the block communicators of
+        assembleComplementComms; call with the same values on all ranks */
+    void setSearchBalance(int flag, double tolerance = 0.1)
+    {
+        searchBalance = flag;
+        searchBalanceTol = tolerance;
+    }
+
+    /** force a full search in the next performConnectivity */
+    void requestFullConnectivity()
+    {
+        fullConnectivityRequested = 1;
+        fullAMRConnectivityRequested = 1;
+    }
+
+    /** accumulate the phase times of the connectivity and data update
+        calls on each rank, on by default with TIOGA_ENABLE_TIMERS */
+    void setProfiling(int flag) { profiler.setEnabled(flag != 0); }
+
+    /** discard the accumulated phase times */
+    void resetProfile() { profiler.reset(); }
+
+    /** collective: reduce the phase times over the ranks, print them on
+        rank 0 and write them as JSON to jsonFile if given. The reduced
+        min/avg/max are then available on all ranks from getProfiler().
+        Does nothing while profiling is off */
+    void reportProfile(const char* jsonFile = nullptr);
+
+    const phaseProfiler& getProfiler() const { return profiler; }
+
+    /** count the messages, bytes, peers and wait time of the packet
+        exchanges per phase, on by default with TIOGA_ENABLE_TIMERS */
+    void setCommStats(int flag) { commStatistics.setEnabled(flag != 0); }
+
+    /** discard the communication counts */
+    void resetCommStats() { commStatistics.reset(); }
+
+    /** collective: reduce the communication counts over the ranks, print
+        them on rank 0 and write the rank to rank volume matrix to
+        matrixFile if given. Does nothing while the counts are off */
+    void reportCommStats(const char* matrixFile = nullptr);
+
+    const commStats& getCommStats() const { return commStatistics; }
+
+    /** search counters of the mesh blocks of this rank, summed over the
+        blocks and threads, all zero without TIOGA_OUTPUT_STATS */
+    searchCounters getSearchCounters() const;
+
+    /** record what MeshBlock::search and processDonors work on in the
+        next ncalls performConnectivity calls, on rank (-1: all ranks), one
+        file <prefix>.r<rank>.b<block>.c<call>.trec per block for
+        bench/tioga_replay. An empty prefix stops the recording */
+    void setConnectivityCapture(
+        const char* prefix, int rank = -1, int ncalls = 1);
+
+    /** open the records of this performConnectivity call if any */
+    void beginConnectivityCapture();
+    void endConnectivityCapture();
+
+    /** collective: write the connectivity of this rank (iblanks,
+        interpolation lists and communication maps) to
+        <prefix>.r<rank>.tckp, returns 0 if all ranks wrote theirs. Not
+        available for high-order interpolation */
+    int writeConnectivityCheckpoint(const char* prefix);
+
+    /** collective: restore the connectivity of a checkpoint in place of
+        performConnectivity and performConnectivityAMR, for dataUpdate and
+        dataUpdate_AMR on the same meshes, ranks and blocks. The files are
+        mapped and validated against the registered meshes first: if any
+        rank cannot restore, nothing changes and the error is returned */
+    int restoreConnectivity(const char* prefix);
+
+    /** number of AMR patches new or changed in the last
+        performConnectivityAMR (all of them after a full search) */
+    int getChangedAMRPatchCount() const { return nAMRPatchChanged; }
+
+    /** set the rigid motion of a body, x = rot*x_ref + trans with rot
+        given row major. If all bodies with walls have a rigid motion the
+        hole maps are built once and query points are mapped back into the
+        frame they were built in. Must be called with identical data on all
+        ranks before performConnectivity */
+    void setRigidBodyMotion(int btag, const double* rot, const double* trans)
+    {
+        std::array<double, 12> motion;
+        for (int i = 0; i < 9; i++) {
+            motion[i] = rot[i];
+        }
+        for (int i = 0; i < 3; i++) {
+            motion[9 + i] = trans[i];
+        }
+        rigidMotion[btag] = motion;
+    }
+
+    /** body btag deforms again, its hole map is rebuilt every call */
+    void clearRigidBodyMotion(int btag) { rigidMotion.erase(btag); }
+
+    /** discard the cached rigid body hole maps */
+    void resetRigidBodyHoleMaps() { rigidHoleMapAlg = -1; }
+
+    /** allocation counters of the connectivity lifetime lists */
+    const connectivityArena& getConnectivityArena() const { return arena; }
+    const connectivityArena& getCartArena() const { return cartArena; }
+
     void set_cell_iblank(int* iblank_cell)
     {
         auto& mb = mblocks[0];
@@ -2,6 +2,7 @@
 #define TIOGA_MATH_H
 double computeCellVolume(double xv[8][3], int nvert);
 double tdot_product(const double a[3], const double b[3], const double c[3]);
-void computeNodalWeights(
+/** returns the Newton iterations taken, 0 for tetrahedra */
+int computeNodalWeights(
     double xv[8][3], const double* xp, double frac[8], int nvert);
 #endif
@@ -69,31 +69,22 @@ void findOBB(
     double* x, double xc[3], double dxc[3], double vec[3][3], int nnodes);
 int checkHoleMap(
     const double* x, const int* nx, int* sam, const double* extents);
+int checkHoleMap(const double* x, const HOLEMAP* holemap);
+void checkHoleMap(
+    int npts, const double* xpts, const HOLEMAP* holemap, int* inhole);
+void rigidTransformPoint(const double* xform, const double* x, double* xt);
 int checkAdaptiveHoleMap(double* xpt, ADAPTIVE_HOLEMAP* AHM);
+void checkAdaptiveHoleMap(
+    int npts, const double* xpts, ADAPTIVE_HOLEMAP* AHM, int* sbval);
+void buildAdaptiveHoleMapIndex(ADAPTIVE_HOLEMAP* AHM);
 void fillHoleMap(int* holeMap, const int ix[3], int isym);
 void octant_children(
     uint8_t children_level,
-    uint32_t idx,
-    octant_full_t* q,
-    octant_full_t* c0,
-    octant_full_t* c1,
-    octant_full_t* c2,
-    octant_full_t* c3,
-    octant_full_t* c4,
-    octant_full_t* c5,
-    octant_full_t* c6,
-    octant_full_t* c7);
-void octant_children_neighbors(
-    const octant_full_t* q,
-    octant_full_t* c0,
-    octant_full_t* c1,
-    octant_full_t* c2,
-    octant_full_t* c3,
-    octant_full_t* c4,
-    octant_full_t* c5,
-    octant_full_t* c6,
-    octant_full_t* c7);
-void floodfill_level(level_octant_t* level);
+    const octant_coordinates_t* q,
+    octant_coordinates_t* c,
+    uint8_t* filltype);
+uint32_t refine_level(const level_octant_t* lvl, level_octant_t* new_lvl);
+void floodfill_level(level_octant_t* levels, int level_id);
 int obbIntersectCheck(
     double vA[3][3],
     const double xA[3],
@@ -120,7 +111,10 @@ void uniqNodesTree(
     int nav);
 void uniquenodes_octree(
     double* x, int* meshtag, double* rtag, int* itag, const int* nn);
+void uniquenode_map(
+    uint64_t* node_ids, double* node_res, int* itag, int nnodes);
 
+uint64_t octant_morton_key(uint32_t ix, uint32_t iy, uint32_t iz);
 void qcoord_to_vertex(
     qcoord_t x, qcoord_t y, qcoord_t z, const double* vertices, double vxyz[3]);
 char checkFaceBoundaryNodes(
@@ -0,0 +1,105 @@
+//
+// This file is part of the Tioga software library
+//
+// Tioga  is a tool for overset grid assembly on parallel distributed systems
+// Copyright (C) 2015 Jay Sitaraman
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+#ifndef VTKWRITER_H
+#define VTKWRITER_H
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Binary VTK XML writer: unstructured grid pieces (.vtu), their parallel
+ * index (.pvtu) and uniform grids (.vti).
+ *
+ * The arrays go in the appended section as raw native byte order data, each
+ * preceded by its UInt64 byte count. They are not held by the writer: each
+ * array has a fill function that writes the tuples begin..end-1 into a
+ * buffer, called one chunk at a time while the file is written, so the
+ * output never needs a full copy of the mesh or solution.
+ */
+class vtkWriter
+{
+public:
+    enum dataType
+    {
+        INT32,
+        INT64,
+        UINT8,
+        FLOAT64
+    };
+
+    /** writes the tuples [begin,end) of an array (components interleaved) */
+    typedef std::function<void(size_t begin, size_t end, void* buf)> fillFunc;
+
+    /** unstructured grid piece */
+    vtkWriter(size_t npointsi, size_t ncellsi);
+
+    /** uniform grid of nx cells */
+    vtkWriter(
+        const int nxi[3], const double origini[3], const double spacingi[3]);
+
+    /** point coordinates, 3 Float64 per point */
+    void setPoints(fillFunc fill);
+
+    /** cells: nconn Int64 node indices, ncells Int64 end offsets into them
+        and ncells UInt8 VTK cell types */
+    void setCells(
+        size_t nconn, fillFunc connectivity, fillFunc offsets, fillFunc types);
+
+    void
+    addPointData(const char* name, dataType type, int ncomp, fillFunc fill);
+    void
+    addCellData(const char* name, dataType type, int ncomp, fillFunc fill);
+
+    /** write the file, returns 0 on success */
+    int write(const char* fname) const;
+
+    /** write the .pvtu index of pieces with the same arrays as this one,
+        the piece names are relative to the index. Returns 0 on success */
+    int writeIndex(const char* fname, const std::vector<std::string>& pieces)
+        const;
+
+    /** VTK cell type of a linear element with nvert vertices */
+    static unsigned char cellType(int nvert);
+
+private:
+    struct array
+    {
+        std::string name;
+        dataType type;
+        int ncomp;
+        size_t ntuples;
+        fillFunc fill;
+    };
+
+    bool imageData;
+    size_t npoints;
+    size_t ncells;
+    int nx[3];
+    double origin[3];
+    double spacing[3];
+    std::vector<array> pointData;
+    std::vector<array> cellData;
+    std::vector<array> points; /** < coordinates, empty for image data */
+    std::vector<array> cells;  /** < connectivity, offsets and types */
+};
+
+#endif /* VTKWRITER_H */